@@ -11,6 +11,8 @@ auto bundle(const std::span<const std::string> &arguments) -> int;
 auto test(const std::span<const std::string> &arguments) -> int;
 auto lint(const std::span<const std::string> &arguments) -> int;
 auto validate(const std::span<const std::string> &arguments) -> int;
+auto watch(const std::span<const std::string> &arguments) -> int;
+auto query(const std::span<const std::string> &arguments) -> int;
 } // namespace intelligence::jsonschema::cli
 
 #endif
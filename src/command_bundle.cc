@@ -17,7 +17,7 @@ auto intelligence::jsonschema::cli::bundle(
       resolver(options, options.contains("h") || options.contains("http")))
       .wait();
   sourcemeta::jsontoolkit::prettify(
-      schema, std::cout, sourcemeta::jsontoolkit::schema_format_compare);
+      schema, std::cout, sourcemeta::jsontoolkit::schema_format_rank);
   std::cout << std::endl;
   return EXIT_SUCCESS;
 }
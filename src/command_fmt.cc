@@ -20,26 +20,19 @@ auto intelligence::jsonschema::cli::fmt(
       std::ifstream input{entry.first};
       std::ostringstream buffer;
       buffer << input.rdbuf();
-      std::ostringstream expected;
-      sourcemeta::jsontoolkit::prettify(
-          entry.second, expected,
-          sourcemeta::jsontoolkit::schema_format_compare);
-      expected << "\n";
+      const auto expected{prettify_schema(entry.second)};
 
-      if (buffer.str() == expected.str()) {
+      if (buffer.str() == expected) {
         log_verbose(options) << "PASS: " << entry.first.string() << "\n";
       } else {
-        std::cerr << "FAIL: " << entry.first.string() << "\n";
-        std::cerr << "Got: \n"
-                  << buffer.str() << "\nBut expected:\n"
-                  << expected.str() << "\n";
+        pretty_format_error(std::cerr, entry.first, buffer.str(), expected);
         return EXIT_FAILURE;
       }
     } else {
       log_verbose(options) << "Formatting: " << entry.first.string() << "\n";
       std::ofstream output{entry.first};
       sourcemeta::jsontoolkit::prettify(
-          entry.second, output, sourcemeta::jsontoolkit::schema_format_compare);
+          entry.second, output, sourcemeta::jsontoolkit::schema_format_rank);
       output << std::endl;
     }
   }
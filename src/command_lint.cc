@@ -29,7 +29,7 @@ auto intelligence::jsonschema::cli::lint(
                    resolver(options));
       std::ofstream output{entry.first};
       sourcemeta::jsontoolkit::prettify(
-          copy, output, sourcemeta::jsontoolkit::schema_format_compare);
+          copy, output, sourcemeta::jsontoolkit::schema_format_rank);
       output << std::endl;
     }
   } else {
@@ -40,10 +40,7 @@ auto intelligence::jsonschema::cli::lint(
           entry.second, sourcemeta::jsontoolkit::default_schema_walker,
           resolver(options),
           [&entry](const auto &pointer, const auto &name, const auto &message) {
-            std::cout << entry.first.string() << "\n";
-            std::cout << "    ";
-            sourcemeta::jsontoolkit::stringify(pointer, std::cout);
-            std::cout << " " << message << " (" << name << ")\n";
+            pretty_lint_error(std::cout, entry.first, pointer, name, message);
           });
 
       if (subresult) {
@@ -1,15 +1,414 @@
 #include <sourcemeta/jsontoolkit/json.h>
 #include <sourcemeta/jsontoolkit/jsonschema.h>
 
-#include <cstdlib>  // EXIT_SUCCESS, EXIT_FAILURE
-#include <iostream> // std::cerr
-#include <set>      // std::set
-#include <string>   // std::string
+#include <algorithm>          // std::any_of, std::max
+#include <charconv>           // std::from_chars
+#include <chrono>             // std::chrono
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <cstdint>            // std::uintmax_t
+#include <cstdlib>            // EXIT_SUCCESS, EXIT_FAILURE
+#include <deque>              // std::deque
+#include <filesystem>         // std::filesystem
+#include <fstream>            // std::ifstream
+#include <ios>                // std::ios_base
+#include <iostream>           // std::cerr, std::cout
+#include <istream>            // std::istream
+#include <mutex>              // std::mutex, std::lock_guard, std::unique_lock
+#include <optional>           // std::optional, std::nullopt
+#include <set>                // std::set
+#include <sstream>            // std::ostringstream
+#include <stdexcept>          // std::runtime_error
+#include <streambuf>          // std::streambuf
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <system_error>       // std::errc
+#include <thread>             // std::thread
+#include <utility>            // std::move, std::exchange
+#include <vector>             // std::vector
+
+#if !defined(_WIN32)
+#include <fcntl.h>    // open, O_RDONLY
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat, S_ISREG
+#include <unistd.h>   // close
+#endif
 
 #include "command.h"
 #include "utils.h"
 
-// TODO: Add a flag to emit output using the standard JSON Schema output format
+namespace {
+
+// A blocking queue with a fixed capacity, so that reading ahead of the
+// evaluators never buffers more than a handful of documents in memory
+template <typename T> class BoundedQueue {
+public:
+  BoundedQueue(const std::size_t capacity) : capacity_{capacity} {}
+
+  auto push(T &&value) -> void {
+    std::unique_lock<std::mutex> lock{this->mutex_};
+    this->not_full_.wait(
+        lock, [this] { return this->queue_.size() < this->capacity_; });
+    this->queue_.push_back(std::move(value));
+    lock.unlock();
+    this->not_empty_.notify_one();
+  }
+
+  // Returns nothing once the queue is closed and fully drained
+  auto pop() -> std::optional<T> {
+    std::unique_lock<std::mutex> lock{this->mutex_};
+    this->not_empty_.wait(
+        lock, [this] { return !this->queue_.empty() || this->closed_; });
+    if (this->queue_.empty()) {
+      return std::nullopt;
+    }
+
+    T value{std::move(this->queue_.front())};
+    this->queue_.pop_front();
+    lock.unlock();
+    this->not_full_.notify_one();
+    return value;
+  }
+
+  auto close() -> void {
+    {
+      std::lock_guard<std::mutex> lock{this->mutex_};
+      this->closed_ = true;
+    }
+
+    this->not_empty_.notify_all();
+  }
+
+private:
+  const std::size_t capacity_;
+  std::deque<T> queue_;
+  bool closed_{false};
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+};
+
+// Read a file as a stream, which also works for pipes and other special
+// files whose size is not known in advance
+auto read_file(const std::filesystem::path &path) -> std::string {
+  std::ifstream stream{path, std::ios_base::binary};
+  stream.exceptions(std::ios_base::badbit);
+  if (!stream) {
+    std::ostringstream error;
+    error << "Could not read file: " << path.string();
+    throw std::runtime_error(error.str());
+  }
+
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
+}
+
+// A read-only view over the contents of a file. Where possible, regular files
+// are memory-mapped, so that the parts of an instance that parsing skips over
+// are never copied around
+class MappedFile {
+public:
+  MappedFile(const std::filesystem::path &path) {
+#if defined(_WIN32)
+    this->contents_ = read_file(path);
+#else
+    const auto descriptor{open(path.c_str(), O_RDONLY)};
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) != 0) {
+      if (descriptor >= 0) {
+        close(descriptor);
+      }
+
+      std::ostringstream error;
+      error << "Could not read file: " << path.string();
+      throw std::runtime_error(error.str());
+    }
+
+    // Things like pipes or `/dev/stdin` report no meaningful size
+    if (!S_ISREG(status.st_mode)) {
+      close(descriptor);
+      this->contents_ = read_file(path);
+      return;
+    }
+
+    this->size_ = static_cast<std::size_t>(status.st_size);
+    // Mapping an empty file is an error
+    if (this->size_ > 0) {
+      this->data_ =
+          mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+
+    close(descriptor);
+    if (this->data_ == MAP_FAILED) {
+      this->data_ = nullptr;
+      std::ostringstream error;
+      error << "Could not map file: " << path.string();
+      throw std::runtime_error(error.str());
+    }
+
+    // Start paging the file in while it waits for an available worker
+    if (this->data_ != nullptr) {
+      madvise(this->data_, this->size_, MADV_WILLNEED);
+    }
+#endif
+  }
+
+  ~MappedFile() {
+#if !defined(_WIN32)
+    if (this->data_ != nullptr) {
+      munmap(this->data_, this->size_);
+    }
+#endif
+  }
+
+#if defined(_WIN32)
+  MappedFile(MappedFile &&other) noexcept = default;
+#else
+  MappedFile(MappedFile &&other) noexcept
+      : contents_{std::move(other.contents_)},
+        data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+#endif
+
+  MappedFile(const MappedFile &) = delete;
+  auto operator=(const MappedFile &) -> MappedFile & = delete;
+  auto operator=(MappedFile &&) -> MappedFile & = delete;
+
+  auto view() const -> std::string_view {
+#if !defined(_WIN32)
+    if (this->data_ != nullptr) {
+      return {static_cast<const char *>(this->data_), this->size_};
+    }
+#endif
+
+    return this->contents_;
+  }
+
+private:
+  std::string contents_;
+#if !defined(_WIN32)
+  void *data_{nullptr};
+  std::size_t size_{0};
+#endif
+};
+
+// Expose a view over memory as a standard input stream without copying it
+class ViewBuffer : public std::streambuf {
+public:
+  ViewBuffer(const std::string_view view) {
+    // The get area is never written to
+    auto *begin{const_cast<char *>(view.data())};
+    this->setg(begin, begin, begin + view.size());
+  }
+};
+
+// Only materialize the parts of the instance that the schema might read
+auto parse_instance(
+    const MappedFile &file,
+    const sourcemeta::jsontoolkit::ParseProjection &instance_projection)
+    -> sourcemeta::jsontoolkit::JSON {
+  ViewBuffer buffer{file.view()};
+  std::istream stream{&buffer};
+  return sourcemeta::jsontoolkit::parse(stream, instance_projection);
+}
+
+// How to report the result of evaluating an instance
+struct OutputOptions {
+  std::optional<sourcemeta::jsontoolkit::SchemaCompilerOutputFormat> format;
+  std::optional<std::size_t> max_errors;
+};
+
+auto parse_output_options(
+    const std::map<std::string, std::vector<std::string>> &options)
+    -> OutputOptions {
+  OutputOptions result;
+  for (const auto &name : {"output", "o"}) {
+    if (!options.contains(name) || options.at(name).empty()) {
+      continue;
+    }
+
+    const auto &value{options.at(name).back()};
+    if (value == "flag") {
+      result.format = sourcemeta::jsontoolkit::SchemaCompilerOutputFormat::Flag;
+    } else if (value == "basic") {
+      result.format =
+          sourcemeta::jsontoolkit::SchemaCompilerOutputFormat::Basic;
+    } else if (value == "detailed") {
+      result.format =
+          sourcemeta::jsontoolkit::SchemaCompilerOutputFormat::Detailed;
+    } else {
+      std::ostringstream error;
+      error << "Unknown output format: " << value;
+      throw std::runtime_error(error.str());
+    }
+  }
+
+  if (options.contains("max-errors")) {
+    // The value is missing if the option comes last, or if it is followed by
+    // something that looks like another option, like a negative number
+    const std::string value{options.at("max-errors").empty()
+                                ? ""
+                                : options.at("max-errors").back()};
+    std::size_t max_errors{0};
+    const auto *const end{value.data() + value.size()};
+    const auto parsed{std::from_chars(value.data(), end, max_errors)};
+    if (parsed.ec != std::errc{} || parsed.ptr != end || max_errors == 0) {
+      std::ostringstream error;
+      error << "The maximum number of errors must be a positive integer: "
+            << value;
+      throw std::runtime_error(error.str());
+    }
+
+    if (result.format !=
+            sourcemeta::jsontoolkit::SchemaCompilerOutputFormat::Basic &&
+        result.format !=
+            sourcemeta::jsontoolkit::SchemaCompilerOutputFormat::Detailed) {
+      throw std::runtime_error("The maximum number of errors only applies to "
+                               "the basic and detailed output formats");
+    }
+
+    result.max_errors = max_errors;
+  }
+
+  return result;
+}
+
+auto evaluate_instance(
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate &schema_template,
+    const sourcemeta::jsontoolkit::JSON &instance, const OutputOptions &output,
+    std::ostream &stream) -> bool {
+  if (output.format.has_value()) {
+    return sourcemeta::jsontoolkit::evaluate(schema_template, instance,
+                                             output.format.value(), stream,
+                                             output.max_errors);
+  }
+
+  return intelligence::jsonschema::cli::pretty_evaluate(schema_template,
+                                                        instance, stream);
+}
+
+struct InstanceDocument {
+  std::filesystem::path path;
+  MappedFile file;
+};
+
+class InstanceReport {
+public:
+  auto pass(const std::filesystem::path &path, const std::size_t bytes,
+            std::ostream &verbose) -> void {
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    this->passed_ += 1;
+    this->bytes_ += bytes;
+    verbose << "PASS: " << path.string() << "\n";
+  }
+
+  auto fail(const std::filesystem::path &path, const std::size_t bytes,
+            const std::string &details) -> void {
+    std::lock_guard<std::mutex> lock{this->mutex_};
+    this->failures_.push_back(path.string());
+    this->bytes_ += bytes;
+    std::cerr << "FAIL: " << path.string() << "\n" << details;
+  }
+
+  auto failed() const -> bool { return !this->failures_.empty(); }
+
+  auto summary(std::ostream &stream,
+               const std::chrono::duration<double> elapsed) const -> void {
+    const auto total{this->passed_ + this->failures_.size()};
+    const auto seconds{std::max(elapsed.count(), 1e-9)};
+    stream << "Validated " << total << " instance(s): " << this->passed_
+           << " passed, " << this->failures_.size() << " failed\n";
+    stream << "Throughput: "
+           << static_cast<std::uintmax_t>(static_cast<double>(total) / seconds)
+           << " instances/s, "
+           << static_cast<std::uintmax_t>(
+                  static_cast<double>(this->bytes_) / 1024 / seconds)
+           << " KiB/s over " << elapsed.count() << "s\n";
+    for (const auto &failure : this->failures_) {
+      stream << "    " << failure << "\n";
+    }
+  }
+
+private:
+  std::size_t passed_{0};
+  std::uintmax_t bytes_{0};
+  std::vector<std::string> failures_;
+  std::mutex mutex_;
+};
+
+// Validate many instances against an already compiled schema by overlapping
+// file reads (on a dedicated read-ahead thread) with parsing and evaluation
+// (on a pool of workers), connected through a bounded queue
+auto validate_instances(
+    const std::map<std::string, std::vector<std::string>> &options,
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate &schema_template,
+    const sourcemeta::jsontoolkit::ParseProjection &instance_projection,
+    const OutputOptions &output,
+    const std::vector<std::filesystem::path> &instances) -> bool {
+  using namespace intelligence::jsonschema::cli;
+  const auto start{std::chrono::steady_clock::now()};
+  const std::size_t workers{
+      std::max(1u, std::thread::hardware_concurrency())};
+  log_verbose(options) << "Validating " << instances.size()
+                       << " instance(s) using " << workers << " worker(s)\n";
+
+  InstanceReport report;
+  BoundedQueue<InstanceDocument> queue{workers * 4};
+  std::thread reader{[&instances, &queue, &report] {
+    for (const auto &path : instances) {
+      try {
+        queue.push({path, MappedFile{path}});
+      } catch (const std::exception &error) {
+        report.fail(path, 0, std::string{"error: "} + error.what() + "\n");
+      }
+    }
+
+    queue.close();
+  }};
+
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (std::size_t index = 0; index < workers; index++) {
+    pool.emplace_back([&options, &schema_template, &instance_projection,
+                       &output, &queue, &report] {
+      while (auto document{queue.pop()}) {
+        const auto bytes{document->file.view().size()};
+        std::ostringstream details;
+        try {
+          const auto instance{
+              parse_instance(document->file, instance_projection)};
+          const auto result{
+              evaluate_instance(schema_template, instance, output, details)};
+
+          if (result) {
+            report.pass(document->path, bytes, log_verbose(options));
+          } else {
+            report.fail(document->path, bytes, details.str());
+          }
+        } catch (const sourcemeta::jsontoolkit::ParseError &error) {
+          details << "error: " << error.what() << " at line " << error.line()
+                  << " and column " << error.column() << "\n";
+          report.fail(document->path, bytes, details.str());
+        } catch (const std::exception &error) {
+          details << "error: " << error.what() << "\n";
+          report.fail(document->path, bytes, details.str());
+        }
+      }
+    });
+  }
+
+  reader.join();
+  for (auto &worker : pool) {
+    worker.join();
+  }
+
+  report.summary(std::cout, std::chrono::steady_clock::now() - start);
+  return !report.failed();
+}
+
+} // namespace
+
 // TODO: Add a flag to collect annotations
 auto intelligence::jsonschema::cli::validate(
     const std::span<const std::string> &arguments) -> int {
@@ -17,6 +416,7 @@ auto intelligence::jsonschema::cli::validate(
       parse_options(arguments, {"h", "http", "m", "metaschema"})};
   CLI_ENSURE(options.at("").size() >= 1, "You must pass a schema")
   const auto &schema_path{options.at("").at(0)};
+  const auto output{parse_output_options(options)};
   const auto custom_resolver{
       resolver(options, options.contains("h") || options.contains("http"))};
 
@@ -41,20 +441,54 @@ auto intelligence::jsonschema::cli::validate(
 
   bool result{true};
   if (options.at("").size() >= 2) {
-    const auto &instance_path{options.at("").at(1)};
+    const std::vector<std::string> instance_arguments{
+        options.at("").cbegin() + 1, options.at("").cend()};
     const auto schema_template{sourcemeta::jsontoolkit::compile(
         schema, sourcemeta::jsontoolkit::default_schema_walker, custom_resolver,
         sourcemeta::jsontoolkit::default_schema_compiler)};
+    const auto instance_projection{
+        sourcemeta::jsontoolkit::projection(schema_template)};
+
+    // Passing a directory or more than one instance means batch validation
+    if (instance_arguments.size() > 1 ||
+        std::any_of(instance_arguments.cbegin(), instance_arguments.cend(),
+                    [](const auto &argument) {
+                      return std::filesystem::is_directory(argument);
+                    })) {
+      // Every instance would need its own output document
+      CLI_ENSURE(!output.format.has_value(),
+                 "The output formats only support validating one instance")
 
-    const auto instance{sourcemeta::jsontoolkit::from_file(instance_path)};
+      // Explicitly listed files are always validated, no matter their
+      // extension, while directories are scanned for the given extensions
+      std::vector<std::filesystem::path> instances;
+      const auto extensions{parse_extensions(options)};
+      for (const auto &argument : instance_arguments) {
+        if (std::filesystem::is_directory(argument)) {
+          for (auto &path : for_each_json_path({argument}, extensions)) {
+            instances.push_back(std::move(path));
+          }
+        } else {
+          CLI_ENSURE(std::filesystem::exists(argument),
+                     "No such file or directory: " << argument)
+          instances.emplace_back(argument);
+        }
+      }
+
+      result = validate_instances(options, schema_template,
+                                  instance_projection, output, instances);
+    } else {
+      const MappedFile instance_file{instance_arguments.front()};
+      const auto instance{parse_instance(instance_file, instance_projection)};
 
-    result = sourcemeta::jsontoolkit::evaluate(
-        schema_template, instance,
-        sourcemeta::jsontoolkit::SchemaCompilerEvaluationMode::Fast,
-        pretty_evaluate_callback);
+      // Standard output formats are meant to be consumed by other programs
+      result = evaluate_instance(schema_template, instance, output,
+                                 output.format.has_value() ? std::cout
+                                                           : std::cerr);
 
-    if (result) {
-      log_verbose(options) << "Valid\n";
+      if (result) {
+        log_verbose(options) << "Valid\n";
+      }
     }
   }
 
@@ -0,0 +1,977 @@
+#include <sourcemeta/jsontoolkit/json.h>
+#include <sourcemeta/jsontoolkit/jsonschema.h>
+
+#include <cstdlib>     // EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>    // std::cerr, std::cout
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+#include "command.h"
+#include "utils.h"
+
+#if defined(__linux__)
+#include <algorithm>  // std::any_of, std::find_if, std::mismatch, std::min
+#include <array>      // std::array
+#include <cerrno>     // errno, EINTR, EAGAIN, EWOULDBLOCK
+#include <chrono>     // std::chrono
+#include <csignal>    // std::signal, std::sig_atomic_t, SIGINT, SIGTERM
+#include <cstddef>    // std::size_t
+#include <cstring>    // std::memcpy
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ifstream
+#include <future>     // std::future
+#include <map>        // std::map
+#include <memory>     // std::unique_ptr, std::make_unique
+#include <optional>   // std::optional
+#include <set>        // std::set
+#include <sstream>    // std::ostringstream
+#include <stdexcept>  // std::runtime_error
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+#include <poll.h>        // poll, pollfd, POLLIN
+#include <sys/inotify.h> // inotify_init1, inotify_add_watch, inotify_event
+#include <sys/socket.h>  // socket, bind, listen, accept, connect, send, recv
+#include <sys/un.h>      // sockaddr_un
+#include <unistd.h>      // close, read
+
+namespace {
+
+// Own a POSIX file descriptor
+class Descriptor {
+public:
+  Descriptor(const int descriptor, const char *const what)
+      : descriptor_{descriptor} {
+    if (this->descriptor_ < 0) {
+      throw std::runtime_error(what);
+    }
+  }
+
+  ~Descriptor() { close(this->descriptor_); }
+  Descriptor(const Descriptor &) = delete;
+  Descriptor(Descriptor &&) = delete;
+  auto operator=(const Descriptor &) -> Descriptor & = delete;
+  auto operator=(Descriptor &&) -> Descriptor & = delete;
+
+  auto get() const noexcept -> int { return this->descriptor_; }
+
+private:
+  const int descriptor_;
+};
+
+auto socket_address(const std::filesystem::path &path) -> sockaddr_un {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const auto &value{path.native()};
+  if (value.size() >= sizeof(address.sun_path)) {
+    std::ostringstream error;
+    error << "The socket path is too long: " << value;
+    throw std::runtime_error(error.str());
+  }
+
+  std::memcpy(address.sun_path, value.c_str(), value.size() + 1);
+  return address;
+}
+
+auto send_all(const int descriptor, const std::string &data) -> void {
+  std::size_t offset{0};
+  while (offset < data.size()) {
+    const auto written{send(descriptor, data.data() + offset,
+                            data.size() - offset, MSG_NOSIGNAL)};
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      throw std::runtime_error("Could not write to the socket");
+    }
+
+    offset += static_cast<std::size_t>(written);
+  }
+}
+
+// Read from the socket until the end of the first line, or until the peer
+// stops writing. This blocks, so the daemon must not use it
+auto receive_line(const int descriptor) -> std::string {
+  std::string result;
+  std::array<char, 4096> buffer;
+  while (true) {
+    const auto count{recv(descriptor, buffer.data(), buffer.size(), 0)};
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      throw std::runtime_error("Could not read from the socket");
+    } else if (count == 0) {
+      return result;
+    }
+
+    result.append(buffer.data(), static_cast<std::size_t>(count));
+    const auto newline{result.find('\n')};
+    if (newline != std::string::npos) {
+      result.resize(newline);
+      return result;
+    }
+  }
+}
+
+auto read_contents(const std::filesystem::path &path) -> std::string {
+  std::ifstream stream{path};
+  if (!stream) {
+    std::ostringstream error;
+    error << "Could not read file: " << path.string();
+    throw std::runtime_error(error.str());
+  }
+
+  std::ostringstream buffer;
+  buffer << stream.rdbuf();
+  return buffer.str();
+}
+
+struct WatchResult {
+  bool valid;
+  std::string output;
+};
+
+// Everything the daemon keeps in memory about a single watched schema
+struct WatchedSchema {
+  std::string contents;
+  std::optional<sourcemeta::jsontoolkit::JSON> document;
+  // Why the schema could not be loaded, if it could not
+  std::optional<std::string> error;
+  sourcemeta::jsontoolkit::ReferenceFrame frame;
+  sourcemeta::jsontoolkit::ReferenceMap references;
+  // The schema resources that this file declares, ready to be resolved
+  std::unique_ptr<sourcemeta::jsontoolkit::MapSchemaResolver> resources;
+  std::set<std::string> identifiers;
+  // The identifiers of the dialects that this file uses
+  std::set<std::string> dialects;
+  // The identifiers of the dialects and schemas that this file refers to
+  std::set<std::string> dependencies;
+  // Computed on demand, and discarded whenever the schema or any of its
+  // dependencies change
+  std::optional<WatchResult> lint;
+  std::optional<WatchResult> format;
+  std::optional<sourcemeta::jsontoolkit::SchemaCompilerTemplate>
+      schema_template;
+};
+
+// The in-memory state of every watched schema, where schemas can resolve
+// each other by identifier
+class Workspace {
+public:
+  Workspace(sourcemeta::jsontoolkit::SchemaResolver fallback)
+      : fallback_{std::move(fallback)} {
+    this->bundle_.add(
+        sourcemeta::jsontoolkit::SchemaTransformBundle::Category::Modernize);
+    this->bundle_.add(
+        sourcemeta::jsontoolkit::SchemaTransformBundle::Category::AntiPattern);
+  }
+
+  auto contains(const std::filesystem::path &path) const -> bool {
+    return this->schemas_.contains(path);
+  }
+
+  auto paths() const -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> result;
+    for (const auto &entry : this->schemas_) {
+      result.push_back(entry.first);
+    }
+
+    return result;
+  }
+
+  // Re-read a schema from disk, along with every schema that depends on it
+  auto update(const std::filesystem::path &path) -> void {
+    std::string contents;
+    try {
+      contents = read_contents(path);
+    } catch (const std::runtime_error &) {
+      // The file is gone by the time we got to it
+      this->remove(path);
+      return;
+    }
+
+    auto &schema{this->schemas_[path]};
+    // Rescanning reads back many schemas that did not really change
+    if (!schema.error.has_value() && schema.document.has_value() &&
+        schema.contents == contents) {
+      return;
+    }
+
+    this->propagate(path, this->refresh(path, schema, std::move(contents)));
+  }
+
+  auto remove(const std::filesystem::path &path) -> void {
+    const auto match{this->schemas_.find(path)};
+    if (match == this->schemas_.end()) {
+      return;
+    }
+
+    const auto changed{this->forget(match->second)};
+    this->schemas_.erase(match);
+    this->propagate(path, changed);
+  }
+
+  auto lint(const std::filesystem::path &path) -> const WatchResult & {
+    auto &schema{this->schemas_.at(path)};
+    if (!schema.lint.has_value()) {
+      if (schema.error.has_value()) {
+        schema.lint = {false, schema.error.value()};
+      } else {
+        std::ostringstream output;
+        const auto valid{this->bundle_.check(
+            schema.document.value(),
+            sourcemeta::jsontoolkit::default_schema_walker, this->resolver(),
+            [&path, &output](const auto &pointer, const auto &name,
+                             const auto &message) {
+              intelligence::jsonschema::cli::pretty_lint_error(
+                  output, path, pointer, name, message);
+            })};
+        schema.lint = {valid, output.str()};
+      }
+    }
+
+    return schema.lint.value();
+  }
+
+  auto format(const std::filesystem::path &path) -> const WatchResult & {
+    auto &schema{this->schemas_.at(path)};
+    if (!schema.format.has_value()) {
+      if (!schema.document.has_value()) {
+        schema.format = {false, schema.error.value()};
+      } else {
+        const auto expected{intelligence::jsonschema::cli::prettify_schema(
+            schema.document.value())};
+        if (schema.contents == expected) {
+          schema.format = {true, ""};
+        } else {
+          std::ostringstream output;
+          intelligence::jsonschema::cli::pretty_format_error(
+              output, path, schema.contents, expected);
+          schema.format = {false, output.str()};
+        }
+      }
+    }
+
+    return schema.format.value();
+  }
+
+  auto validate(const std::filesystem::path &path,
+                const std::vector<std::filesystem::path> &instances)
+      -> WatchResult {
+    auto &schema{this->schemas_.at(path)};
+    if (schema.error.has_value()) {
+      return {false, schema.error.value()};
+    }
+
+    if (!schema.schema_template.has_value()) {
+      schema.schema_template = sourcemeta::jsontoolkit::compile(
+          schema.document.value(),
+          sourcemeta::jsontoolkit::default_schema_walker, this->resolver(),
+          sourcemeta::jsontoolkit::default_schema_compiler);
+    }
+
+    WatchResult result{true, ""};
+    std::ostringstream output;
+    for (const auto &instance_path : instances) {
+      std::ostringstream details;
+      bool valid{false};
+      try {
+        const auto instance{sourcemeta::jsontoolkit::from_file(instance_path)};
+        valid = intelligence::jsonschema::cli::pretty_evaluate(
+            schema.schema_template.value(), instance, details);
+      } catch (const sourcemeta::jsontoolkit::ParseError &error) {
+        details << "error: " << error.what() << " at line " << error.line()
+                << " and column " << error.column() << "\n";
+      } catch (const std::exception &error) {
+        details << "error: " << error.what() << "\n";
+      }
+
+      if (!valid) {
+        result.valid = false;
+        output << instance_path.string() << "\n" << details.str();
+      }
+    }
+
+    result.output = output.str();
+    return result;
+  }
+
+private:
+  auto resolver() const -> sourcemeta::jsontoolkit::SchemaResolver {
+    return [this](std::string_view identifier)
+               -> std::future<std::optional<sourcemeta::jsontoolkit::JSON>> {
+      const auto match{this->identifiers_.find(std::string{identifier})};
+      if (match != this->identifiers_.cend()) {
+        return (*(this->schemas_.at(match->second).resources))(identifier);
+      }
+
+      return this->fallback_(identifier);
+    };
+  }
+
+  // Stop resolving the identifiers of a schema, returning them
+  auto forget(const WatchedSchema &schema) -> std::set<std::string> {
+    for (const auto &identifier : schema.identifiers) {
+      this->identifiers_.erase(identifier);
+    }
+
+    return schema.identifiers;
+  }
+
+  // Frame a schema whose contents were already read, and register its
+  // resources into the workspace
+  auto load(const std::filesystem::path &path, WatchedSchema &schema) -> void {
+    try {
+      schema.document = sourcemeta::jsontoolkit::parse(schema.contents);
+    } catch (const sourcemeta::jsontoolkit::ParseError &error) {
+      std::ostringstream output;
+      output << "error: " << error.what() << " at line " << error.line()
+             << " and column " << error.column() << "\n";
+      schema.error = output.str();
+      return;
+    }
+
+    try {
+      sourcemeta::jsontoolkit::frame(
+          schema.document.value(), schema.frame, schema.references,
+          sourcemeta::jsontoolkit::default_schema_walker, this->resolver())
+          .wait();
+      auto resources{
+          std::make_unique<sourcemeta::jsontoolkit::MapSchemaResolver>(
+              this->resolver())};
+      resources->add(schema.document.value(), schema.frame);
+
+      std::set<std::string> identifiers;
+      std::set<std::string> dialects;
+      for (const auto &[key, entry] : schema.frame) {
+        dialects.insert(entry.dialect);
+        if (entry.type ==
+            sourcemeta::jsontoolkit::ReferenceEntryType::Resource) {
+          const auto owner{this->identifiers_.find(key.second)};
+          if (owner != this->identifiers_.cend() && owner->second != path) {
+            std::ostringstream error;
+            error << "Cannot register the same identifier twice: "
+                  << key.second;
+            throw std::runtime_error(error.str());
+          }
+
+          identifiers.insert(key.second);
+        }
+      }
+
+      std::set<std::string> dependencies{dialects};
+      for (const auto &[key, reference] : schema.references) {
+        if (reference.base.has_value()) {
+          dependencies.insert(reference.base.value());
+        }
+      }
+
+      for (const auto &identifier : identifiers) {
+        this->identifiers_.insert_or_assign(identifier, path);
+      }
+
+      schema.resources = std::move(resources);
+      schema.identifiers = std::move(identifiers);
+      schema.dialects = std::move(dialects);
+      schema.dependencies = std::move(dependencies);
+    } catch (const std::exception &error) {
+      schema.error = std::string{"error: "} + error.what() + "\n";
+    }
+  }
+
+  // Replace the contents of a schema, returning both its old and new
+  // identifiers
+  auto refresh(const std::filesystem::path &path, WatchedSchema &schema,
+               std::string contents) -> std::set<std::string> {
+    auto changed{this->forget(schema)};
+    schema = WatchedSchema{};
+    schema.contents = std::move(contents);
+    this->load(path, schema);
+    changed.insert(schema.identifiers.cbegin(), schema.identifiers.cend());
+    return changed;
+  }
+
+  // Discard what was computed out of every schema that depends on the given
+  // identifiers, and so on transitively. Only schemas whose dialects changed
+  // need to be framed again. Schemas that failed to frame are retried too, as
+  // they might have been waiting for one of these identifiers
+  auto propagate(const std::filesystem::path &origin,
+                 std::set<std::string> changed) -> void {
+    const auto intersects{[&changed](const std::set<std::string> &values) {
+      return std::any_of(
+          values.cbegin(), values.cend(),
+          [&changed](const auto &value) { return changed.contains(value); });
+    }};
+
+    std::set<std::filesystem::path> visited{origin};
+    while (!changed.empty()) {
+      std::set<std::string> next;
+      for (auto &[path, schema] : this->schemas_) {
+        if (visited.contains(path)) {
+          continue;
+        } else if ((schema.error.has_value() && schema.document.has_value()) ||
+                   intersects(schema.dialects)) {
+          visited.insert(path);
+          auto contents{std::move(schema.contents)};
+          next.merge(this->refresh(path, schema, std::move(contents)));
+        } else if (intersects(schema.dependencies)) {
+          visited.insert(path);
+          schema.lint.reset();
+          schema.schema_template.reset();
+          next.insert(schema.identifiers.cbegin(), schema.identifiers.cend());
+        }
+      }
+
+      changed = std::move(next);
+    }
+  }
+
+  std::map<std::filesystem::path, WatchedSchema> schemas_;
+  std::map<std::string, std::filesystem::path> identifiers_;
+  const sourcemeta::jsontoolkit::SchemaResolver fallback_;
+  sourcemeta::jsontoolkit::SchemaTransformBundle bundle_;
+};
+
+auto answer(Workspace &workspace, const sourcemeta::jsontoolkit::JSON &request)
+    -> WatchResult {
+  if (!request.is_array() || request.empty() ||
+      std::any_of(request.as_array().cbegin(), request.as_array().cend(),
+                  [](const auto &argument) { return !argument.is_string(); })) {
+    return {false, "error: Invalid request\n"};
+  }
+
+  const auto &command{request.at(0).to_string()};
+  std::vector<std::filesystem::path> paths;
+  for (std::size_t index = 1; index < request.size(); index++) {
+    paths.emplace_back(request.at(index).to_string());
+  }
+
+  // Instances do not need to be watched
+  const auto watched_end{command == "validate" && !paths.empty()
+                             ? paths.cbegin() + 1
+                             : paths.cend()};
+  const auto unwatched{std::find_if(
+      paths.cbegin(), watched_end,
+      [&workspace](const auto &path) { return !workspace.contains(path); })};
+  if (unwatched != watched_end) {
+    return {false, "error: The schema is not being watched: " +
+                       unwatched->string() + "\n"};
+  }
+
+  if (command == "validate") {
+    if (paths.empty()) {
+      return {false, "error: You must pass a schema\n"};
+    }
+
+    return workspace.validate(paths.front(),
+                              {paths.cbegin() + 1, paths.cend()});
+  } else if (command != "lint" && command != "fmt") {
+    return {false, "error: Unknown command: " + command + "\n"};
+  }
+
+  if (paths.empty()) {
+    paths = workspace.paths();
+  }
+
+  WatchResult result{true, ""};
+  for (const auto &path : paths) {
+    const auto &subresult{command == "lint" ? workspace.lint(path)
+                                            : workspace.format(path)};
+    result.valid = result.valid && subresult.valid;
+    result.output += subresult.output;
+  }
+
+  return result;
+}
+
+// Turn a request line into a response line
+auto serve(Workspace &workspace, const std::string &request) -> std::string {
+  sourcemeta::jsontoolkit::JSON response{
+      sourcemeta::jsontoolkit::JSON::make_object()};
+  try {
+    const auto result{
+        answer(workspace, sourcemeta::jsontoolkit::parse(request))};
+    response.assign("valid", sourcemeta::jsontoolkit::JSON{result.valid});
+    response.assign("output", sourcemeta::jsontoolkit::JSON{result.output});
+  } catch (const std::exception &error) {
+    response.assign("valid", sourcemeta::jsontoolkit::JSON{false});
+    response.assign("output", sourcemeta::jsontoolkit::JSON{
+                                  std::string{"error: "} + error.what() +
+                                  "\n"});
+  }
+
+  std::ostringstream output;
+  sourcemeta::jsontoolkit::stringify(response, output);
+  output << "\n";
+  return output.str();
+}
+
+// A client connection, which the daemon reads from and writes to only as far
+// as it can without blocking, so that a slow client never holds up the rest
+class Session {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Session(const int descriptor)
+      : descriptor_{descriptor, "Could not accept connection"} {
+    this->touch();
+  }
+
+  auto descriptor() const noexcept -> int { return this->descriptor_.get(); }
+  auto deadline() const noexcept -> Clock::time_point {
+    return this->deadline_;
+  }
+
+  auto events() const noexcept -> short {
+    return this->responding_ ? POLLOUT : POLLIN;
+  }
+
+  auto responding() const noexcept -> bool { return this->responding_; }
+
+  // Read what the client sent so far. Returns the request once the client
+  // sent its first line, or stopped writing
+  auto receive() -> std::optional<std::string> {
+    std::array<char, 4096> buffer;
+    while (true) {
+      const auto count{recv(this->descriptor_.get(), buffer.data(),
+                            buffer.size(), MSG_DONTWAIT)};
+      if (count < 0) {
+        if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return std::nullopt;
+        }
+
+        throw std::runtime_error("Could not read from the socket");
+      } else if (count == 0) {
+        return std::move(this->buffer_);
+      }
+
+      this->touch();
+      const auto start{this->buffer_.size()};
+      this->buffer_.append(buffer.data(), static_cast<std::size_t>(count));
+      const auto newline{this->buffer_.find('\n', start)};
+      if (newline != std::string::npos) {
+        this->buffer_.resize(newline);
+        return std::move(this->buffer_);
+      }
+    }
+  }
+
+  auto respond(std::string response) -> void {
+    this->buffer_ = std::move(response);
+    this->offset_ = 0;
+    this->responding_ = true;
+  }
+
+  // Write what is left of the response. Returns whether all of it was written
+  auto flush() -> bool {
+    while (this->offset_ < this->buffer_.size()) {
+      const auto written{send(this->descriptor_.get(),
+                              this->buffer_.data() + this->offset_,
+                              this->buffer_.size() - this->offset_,
+                              MSG_NOSIGNAL | MSG_DONTWAIT)};
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return false;
+        }
+
+        throw std::runtime_error("Could not write to the socket");
+      }
+
+      this->touch();
+      this->offset_ += static_cast<std::size_t>(written);
+    }
+
+    return true;
+  }
+
+private:
+  // Do not let a misbehaving client hold on to the daemon forever, but only
+  // count the time in which the client did nothing
+  auto touch() -> void {
+    this->deadline_ = Clock::now() + std::chrono::seconds{5};
+  }
+
+  const Descriptor descriptor_;
+  Clock::time_point deadline_;
+  std::string buffer_;
+  std::size_t offset_{0};
+  bool responding_{false};
+};
+
+// Keep track of the directories that inotify is watching on our behalf
+class Watcher {
+public:
+  Watcher(const std::set<std::string> &extensions)
+      : descriptor_{inotify_init1(IN_NONBLOCK | IN_CLOEXEC),
+                    "Could not initialize inotify"},
+        extensions_{extensions} {}
+
+  auto descriptor() const noexcept -> int { return this->descriptor_.get(); }
+
+  // Watch a single file, even if its directory is not watched recursively
+  auto file(const std::filesystem::path &path) -> void {
+    this->watch(path.parent_path(), false);
+    this->files_.insert(path);
+  }
+
+  // Watch a directory recursively, returning the schemas it contains
+  auto directory(const std::filesystem::path &path)
+      -> std::vector<std::filesystem::path> {
+    std::vector<std::filesystem::path> result;
+    this->watch(path, true);
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator{path}) {
+      if (entry.is_directory()) {
+        this->watch(entry.path(), true);
+      } else if (this->matches(entry.path())) {
+        result.push_back(entry.path());
+      }
+    }
+
+    return result;
+  }
+
+  // Read every pending event, and report the schemas that were either
+  // written to or removed. If the kernel dropped events, report every schema
+  // that is still around instead, as anything might have changed
+  template <typename Update, typename Remove, typename Rescan>
+  auto drain(const Update &update, const Remove &remove,
+             const Rescan &rescan) -> void {
+    alignas(inotify_event) std::array<char, 16384> buffer;
+    while (true) {
+      const auto count{
+          read(this->descriptor_.get(), buffer.data(), buffer.size())};
+      if (count <= 0) {
+        return;
+      }
+
+      for (std::size_t offset = 0; offset < static_cast<std::size_t>(count);) {
+        inotify_event event;
+        std::memcpy(&event, buffer.data() + offset, sizeof(inotify_event));
+        const auto *const name{buffer.data() + offset + sizeof(inotify_event)};
+        offset += sizeof(inotify_event) + event.len;
+        if (event.mask & IN_Q_OVERFLOW) {
+          rescan(this->rescan());
+          continue;
+        }
+
+        const auto match{this->directories_.find(event.wd)};
+        if (match == this->directories_.cend()) {
+          continue;
+        } else if (event.mask & IN_IGNORED) {
+          this->directories_.erase(match);
+          continue;
+        } else if (event.len == 0) {
+          continue;
+        }
+
+        const auto path{match->second.first / name};
+        const auto recursive{match->second.second};
+        if (event.mask & IN_ISDIR) {
+          if (!recursive) {
+            continue;
+          } else if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+            for (const auto &schema : this->directory(path)) {
+              update(schema);
+            }
+          } else {
+            remove(path);
+          }
+        } else if (this->files_.contains(path) ||
+                   (recursive && this->matches(path))) {
+          if (event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+            update(path);
+          } else if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+            remove(path);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  // Walk every recursively watched directory again, starting from the ones
+  // whose parents are not watched, along with the files watched on their own
+  auto rescan() -> std::set<std::filesystem::path> {
+    std::set<std::filesystem::path> directories;
+    for (const auto &entry : this->directories_) {
+      if (entry.second.second) {
+        directories.insert(entry.second.first);
+      }
+    }
+
+    std::set<std::filesystem::path> result{this->files_};
+    for (const auto &path : directories) {
+      if (!directories.contains(path.parent_path()) &&
+          std::filesystem::is_directory(path)) {
+        for (auto &schema : this->directory(path)) {
+          result.insert(std::move(schema));
+        }
+      }
+    }
+
+    return result;
+  }
+
+  auto watch(const std::filesystem::path &path, const bool recursive) -> void {
+    const auto watch_descriptor{inotify_add_watch(
+        this->descriptor_.get(), path.c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE)};
+    if (watch_descriptor < 0) {
+      std::ostringstream error;
+      error << "Could not watch directory: " << path.string();
+      throw std::runtime_error(error.str());
+    }
+
+    auto &entry{this->directories_[watch_descriptor]};
+    entry.first = path;
+    entry.second = entry.second || recursive;
+  }
+
+  auto matches(const std::filesystem::path &path) const -> bool {
+    return std::any_of(this->extensions_.cbegin(), this->extensions_.cend(),
+                       [&path](const auto &extension) {
+                         return path.string().ends_with(extension);
+                       });
+  }
+
+  const Descriptor descriptor_;
+  const std::set<std::string> extensions_;
+  // From watch descriptors to directories, and whether their schemas are
+  // watched recursively or only if they were explicitly passed
+  std::map<int, std::pair<std::filesystem::path, bool>> directories_;
+  std::set<std::filesystem::path> files_;
+};
+
+volatile std::sig_atomic_t interrupted{0};
+auto interrupt(int) -> void { interrupted = 1; }
+
+} // namespace
+
+auto intelligence::jsonschema::cli::watch(
+    const std::span<const std::string> &arguments) -> int {
+  const auto options{parse_options(arguments, {"h", "http"})};
+  std::optional<std::filesystem::path> socket_path;
+  if (options.contains("socket") && !options.at("socket").empty()) {
+    socket_path = std::filesystem::absolute(options.at("socket").back());
+  } else if (options.contains("s") && !options.at("s").empty()) {
+    socket_path = std::filesystem::absolute(options.at("s").back());
+  }
+
+  CLI_ENSURE(socket_path.has_value(), "You must pass a socket path")
+
+  Workspace workspace{
+      resolver(options, options.contains("h") || options.contains("http"))};
+  Watcher watcher{parse_extensions(options)};
+
+  std::vector<std::filesystem::path> paths;
+  for (const auto &argument :
+       options.at("").empty() ? std::vector<std::string>{"."}
+                              : options.at("")) {
+    const auto path{std::filesystem::weakly_canonical(argument)};
+    if (std::filesystem::is_directory(path)) {
+      for (auto &schema : watcher.directory(path)) {
+        paths.push_back(std::move(schema));
+      }
+    } else {
+      CLI_ENSURE(std::filesystem::exists(path),
+                 "No such file or directory: " << argument)
+      watcher.file(path);
+      paths.push_back(path);
+    }
+  }
+
+  for (const auto &path : paths) {
+    log_verbose(options) << "Watching: " << path.string() << "\n";
+    workspace.update(path);
+  }
+
+  const auto update{[&options, &workspace](const auto &path) {
+    log_verbose(options) << "Updating: " << path.string() << "\n";
+    workspace.update(path);
+  }};
+
+  const auto remove{[&options, &workspace](const auto &path) {
+    for (const auto &schema : workspace.paths()) {
+      if (schema == path ||
+          std::mismatch(path.begin(), path.end(), schema.begin(), schema.end())
+                  .first == path.end()) {
+        log_verbose(options) << "Removing: " << schema.string() << "\n";
+        workspace.remove(schema);
+      }
+    }
+  }};
+
+  // The kernel dropped events, so reload everything we know of, which also
+  // forgets the schemas that are gone by now
+  const auto rescan{[&options, &workspace](auto schemas) {
+    log_verbose(options) << "Rescanning after losing track of changes\n";
+    for (auto &schema : workspace.paths()) {
+      schemas.insert(std::move(schema));
+    }
+
+    for (const auto &schema : schemas) {
+      workspace.update(schema);
+    }
+  }};
+
+  // Listening is the last step, so clients can connect as soon as the
+  // socket exists
+  const auto address{socket_address(socket_path.value())};
+  if (std::filesystem::is_socket(socket_path.value())) {
+    std::filesystem::remove(socket_path.value());
+  }
+
+  const Descriptor listener{
+      socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0),
+      "Could not create socket"};
+  if (bind(listener.get(), reinterpret_cast<const sockaddr *>(&address),
+           sizeof(address)) != 0 ||
+      listen(listener.get(), 16) != 0) {
+    std::ostringstream error;
+    error << "Could not listen on socket: " << socket_path.value().string();
+    throw std::runtime_error(error.str());
+  }
+
+  log_verbose(options) << "Listening on: " << socket_path.value().string()
+                       << "\n";
+  std::signal(SIGINT, interrupt);
+  std::signal(SIGTERM, interrupt);
+
+  // Wait on the file system, on new connections, and on every client at once
+  std::map<int, Session> sessions;
+  std::vector<pollfd> descriptors;
+  while (!interrupted) {
+    descriptors.clear();
+    descriptors.push_back({watcher.descriptor(), POLLIN, 0});
+    descriptors.push_back({listener.get(), POLLIN, 0});
+    int timeout{-1};
+    for (const auto &[descriptor, session] : sessions) {
+      descriptors.push_back({descriptor, session.events(), 0});
+      const auto remaining{std::chrono::ceil<std::chrono::milliseconds>(
+          session.deadline() - Session::Clock::now())};
+      const auto milliseconds{
+          remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0};
+      timeout = timeout < 0 ? milliseconds : std::min(timeout, milliseconds);
+    }
+
+    if (poll(descriptors.data(), descriptors.size(), timeout) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      throw std::runtime_error("Could not wait for events");
+    }
+
+    // Answering other clients might take a while, and that time should not
+    // count against a client that is waiting for its turn
+    const auto now{Session::Clock::now()};
+
+    // Always catch up with the file system before answering, so that a
+    // query right after an edit never sees stale state
+    watcher.drain(update, remove, rescan);
+
+    for (auto iterator = descriptors.cbegin() + 2;
+         iterator != descriptors.cend(); ++iterator) {
+      auto &session{sessions.at(iterator->fd)};
+      if (iterator->revents == 0) {
+        if (session.deadline() <= now) {
+          sessions.erase(iterator->fd);
+        }
+
+        continue;
+      }
+
+      bool done{false};
+      try {
+        if (!session.responding()) {
+          auto request{session.receive()};
+          if (request.has_value()) {
+            session.respond(serve(workspace, request.value()));
+          }
+        }
+
+        done = session.responding() && session.flush();
+      } catch (const std::exception &) {
+        // The client went away, which is not our problem
+        done = true;
+      }
+
+      if (done) {
+        sessions.erase(iterator->fd);
+      }
+    }
+
+    if (descriptors[1].revents & POLLIN) {
+      while (true) {
+        const int connection{accept(listener.get(), nullptr, nullptr)};
+        if (connection < 0) {
+          break;
+        }
+
+        sessions.try_emplace(connection, connection);
+      }
+    }
+  }
+
+  std::filesystem::remove(socket_path.value());
+  return EXIT_SUCCESS;
+}
+
+auto intelligence::jsonschema::cli::query(
+    const std::span<const std::string> &arguments) -> int {
+  const auto options{parse_options(arguments, {})};
+  CLI_ENSURE(options.at("").size() >= 2,
+             "You must pass a socket path and a command")
+
+  // The daemon might be running from another directory
+  auto request{sourcemeta::jsontoolkit::JSON::make_array()};
+  request.push_back(sourcemeta::jsontoolkit::JSON{options.at("").at(1)});
+  for (auto iterator = options.at("").cbegin() + 2;
+       iterator != options.at("").cend(); ++iterator) {
+    request.push_back(sourcemeta::jsontoolkit::JSON{
+        std::filesystem::weakly_canonical(*iterator).string()});
+  }
+
+  const auto address{socket_address(options.at("").front())};
+  const Descriptor connection{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0),
+                              "Could not create socket"};
+  CLI_ENSURE(connect(connection.get(),
+                     reinterpret_cast<const sockaddr *>(&address),
+                     sizeof(address)) == 0,
+             "Could not connect to socket: " << options.at("").front())
+
+  std::ostringstream output;
+  sourcemeta::jsontoolkit::stringify(request, output);
+  output << "\n";
+  send_all(connection.get(), output.str());
+
+  const auto response{
+      sourcemeta::jsontoolkit::parse(receive_line(connection.get()))};
+  std::cout << response.at("output").to_string();
+  return response.at("valid").to_boolean() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+
+auto intelligence::jsonschema::cli::watch(const std::span<const std::string> &)
+    -> int {
+  std::cerr << "The watch command is only supported on Linux\n";
+  return EXIT_FAILURE;
+}
+
+auto intelligence::jsonschema::cli::query(const std::span<const std::string> &)
+    -> int {
+  std::cerr << "The query command is only supported on Linux\n";
+  return EXIT_FAILURE;
+}
+
+#endif
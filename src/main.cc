@@ -21,14 +21,23 @@ Global Options:
 
 Commands:
 
-   validate <schema.json> [instance.json] [--http/-h] [--metaschema/-m]
-
-       If an instance is passed, validate it against the given schema.
-       Otherwise, validate the schema against its dialect metaschema. The
+   validate <schema.json> [instances-or-directories...] [--http/-h]
+            [--metaschema/-m] [--extension/-e <extension>]
+            [--output/-o <flag|basic|detailed>] [--max-errors <count>]
+
+       If instances are passed, validate them against the given schema.
+       Otherwise, validate the schema against its dialect metaschema. Passing
+       more than one instance or a directory of instances compiles the schema
+       once and validates every instance in parallel, printing a summary. The
        `--http/-h` option enables resolving remote schemas over the HTTP
        protocol. The `--metaschema/-m` option checks that the given schema
        is valid with respects to its dialect metaschema even if an instance
-       was passed.
+       was passed. When scanning directories, the `--extension/-e` option is
+       used to prefer a file extension other than `.json`. This option can be
+       set multiple times. The `--output/-o` option prints the result of
+       validating an instance using the given standard JSON Schema output
+       format, and the `--max-errors` option stops validating once the given
+       number of errors was reported in the `basic` or `detailed` formats.
 
    test [schemas-or-directories...] [--http/-h] [--metaschema/-m]
         [--extension/-e <extension>]
@@ -76,6 +85,24 @@ Commands:
        Frame a schema in-place, displaying schema locations and references
        in a human-readable manner.
 
+   watch [schemas-or-directories...] --socket/-s <socket> [--http/-h]
+         [--extension/-e <extension>]
+
+       Keep the input schemas parsed, framed, and compiled in memory, and
+       re-process them as they change on disk, along with the schemas that
+       depend on them. Passing directories as input means to watch every
+       `.json` file in such directory (recursively). If no argument is passed,
+       watch the current working directory. Watched schemas can reference each
+       other by identifier. The daemon answers queries on the given Unix
+       domain socket until interrupted.
+
+   query <socket> <lint|fmt|validate> [arguments...]
+
+       Ask a running `watch` daemon to lint or check the formatting of the
+       given watched schemas (or every watched schema if none is passed), or
+       to validate instances against a watched schema, as in
+       `query <socket> validate <schema.json> [instances...]`.
+
 For more documentation, visit https://github.com/Intelligence-AI/jsonschema
 )EOF"};
 
@@ -93,6 +120,10 @@ auto jsonschema_main(const std::string &program, const std::string &command,
     return intelligence::jsonschema::cli::validate(arguments);
   } else if (command == "test") {
     return intelligence::jsonschema::cli::test(arguments);
+  } else if (command == "watch") {
+    return intelligence::jsonschema::cli::watch(arguments);
+  } else if (command == "query") {
+    return intelligence::jsonschema::cli::query(arguments);
   } else {
     std::cout << "JSON Schema CLI - v"
               << intelligence::jsonschema::cli::PROJECT_VERSION << "\n";
@@ -13,14 +13,13 @@
 #include <set>       // std::set
 #include <sstream>   // std::ostringstream
 #include <stdexcept> // std::runtime_error
+#include <utility>   // std::move
 
 namespace {
 
-auto handle_json_entry(
-    const std::filesystem::path &entry_path,
-    const std::set<std::string> &extensions,
-    std::vector<std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>>
-        &result) -> void {
+auto handle_json_entry(const std::filesystem::path &entry_path,
+                       const std::set<std::string> &extensions,
+                       std::vector<std::filesystem::path> &result) -> void {
   if (std::filesystem::is_directory(entry_path)) {
     for (auto const &entry :
          std::filesystem::recursive_directory_iterator{entry_path}) {
@@ -29,8 +28,7 @@ auto handle_json_entry(
                       [&entry](const auto &extension) {
                         return entry.path().string().ends_with(extension);
                       })) {
-        result.emplace_back(entry.path(),
-                            sourcemeta::jsontoolkit::from_file(entry.path()));
+        result.push_back(entry.path());
       }
     }
   } else {
@@ -44,8 +42,7 @@ auto handle_json_entry(
                     [&entry_path](const auto &extension) {
                       return entry_path.string().ends_with(extension);
                     })) {
-      result.emplace_back(entry_path,
-                          sourcemeta::jsontoolkit::from_file(entry_path));
+      result.push_back(entry_path);
     }
   }
 }
@@ -64,12 +61,10 @@ auto normalize_extension(const std::string &extension) -> std::string {
 
 namespace intelligence::jsonschema::cli {
 
-auto for_each_json(const std::vector<std::string> &arguments,
-                   const std::set<std::string> &extensions)
-    -> std::vector<
-        std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>> {
-  std::vector<std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>>
-      result;
+auto for_each_json_path(const std::vector<std::string> &arguments,
+                        const std::set<std::string> &extensions)
+    -> std::vector<std::filesystem::path> {
+  std::vector<std::filesystem::path> result;
 
   if (arguments.empty()) {
     handle_json_entry(std::filesystem::current_path(), extensions, result);
@@ -82,6 +77,20 @@ auto for_each_json(const std::vector<std::string> &arguments,
   return result;
 }
 
+auto for_each_json(const std::vector<std::string> &arguments,
+                   const std::set<std::string> &extensions)
+    -> std::vector<
+        std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>> {
+  std::vector<std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>>
+      result;
+  for (auto &path : for_each_json_path(arguments, extensions)) {
+    auto document{sourcemeta::jsontoolkit::from_file(path)};
+    result.emplace_back(std::move(path), std::move(document));
+  }
+
+  return result;
+}
+
 auto parse_options(const std::span<const std::string> &arguments,
                    const std::set<std::string> &flags)
     -> std::map<std::string, std::vector<std::string>> {
@@ -130,6 +139,64 @@ auto parse_options(const std::span<const std::string> &arguments,
   return options;
 }
 
+auto pretty_evaluate_error(
+    std::ostream &stream,
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate::value_type &step,
+    const sourcemeta::jsontoolkit::Pointer &evaluate_path,
+    const sourcemeta::jsontoolkit::Pointer &instance_location) -> void {
+  stream << "error: " << sourcemeta::jsontoolkit::describe(step) << "\n";
+  stream << "    at instance location \"";
+  sourcemeta::jsontoolkit::stringify(instance_location, stream);
+  stream << "\"\n";
+
+  stream << "    at evaluate path \"";
+  sourcemeta::jsontoolkit::stringify(evaluate_path, stream);
+  stream << "\"\n";
+}
+
+auto pretty_evaluate(
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate &schema_template,
+    const sourcemeta::jsontoolkit::JSON &instance, std::ostream &stream)
+    -> bool {
+  return sourcemeta::jsontoolkit::evaluate(
+      schema_template, instance,
+      sourcemeta::jsontoolkit::SchemaCompilerEvaluationMode::Fast,
+      [&stream](bool result, const auto &step, const auto &evaluate_path,
+                const auto &instance_location, const auto &, const auto &) {
+        if (!result) {
+          pretty_evaluate_error(stream, step, evaluate_path,
+                                instance_location);
+        }
+      });
+}
+
+auto pretty_lint_error(std::ostream &stream, const std::filesystem::path &path,
+                       const sourcemeta::jsontoolkit::Pointer &pointer,
+                       const std::string_view name,
+                       const std::string_view message) -> void {
+  stream << path.string() << "\n";
+  stream << "    ";
+  sourcemeta::jsontoolkit::stringify(pointer, stream);
+  stream << " " << message << " (" << name << ")\n";
+}
+
+auto prettify_schema(const sourcemeta::jsontoolkit::JSON &schema)
+    -> std::string {
+  std::ostringstream result;
+  sourcemeta::jsontoolkit::prettify(
+      schema, result, sourcemeta::jsontoolkit::schema_format_rank);
+  result << "\n";
+  return result.str();
+}
+
+auto pretty_format_error(std::ostream &stream,
+                         const std::filesystem::path &path,
+                         const std::string &contents,
+                         const std::string &expected) -> void {
+  stream << "FAIL: " << path.string() << "\n";
+  stream << "Got: \n" << contents << "\nBut expected:\n" << expected << "\n";
+}
+
 auto pretty_evaluate_callback(
     bool result,
     const sourcemeta::jsontoolkit::SchemaCompilerTemplate::value_type &step,
@@ -141,14 +208,7 @@ auto pretty_evaluate_callback(
     return;
   }
 
-  std::cerr << "error: " << sourcemeta::jsontoolkit::describe(step) << "\n";
-  std::cerr << "    at instance location \"";
-  sourcemeta::jsontoolkit::stringify(instance_location, std::cerr);
-  std::cerr << "\"\n";
-
-  std::cerr << "    at evaluate path \"";
-  sourcemeta::jsontoolkit::stringify(evaluate_path, std::cerr);
-  std::cerr << "\"\n";
+  pretty_evaluate_error(std::cerr, step, evaluate_path, instance_location);
 }
 
 static auto fallback_resolver(
@@ -193,7 +253,7 @@ static auto fallback_resolver(
 auto resolver(const std::map<std::string, std::vector<std::string>> &options,
               const bool remote) -> sourcemeta::jsontoolkit::SchemaResolver {
   sourcemeta::jsontoolkit::MapSchemaResolver dynamic_resolver{
-      [&remote, &options](std::string_view identifier) {
+      [remote, &options](std::string_view identifier) {
         if (remote) {
           return fallback_resolver(options, identifier);
         } else {
@@ -5,14 +5,15 @@
 #include <sourcemeta/jsontoolkit/jsonpointer.h>
 #include <sourcemeta/jsontoolkit/jsonschema.h>
 
-#include <filesystem> // std::filesystem
-#include <map>        // std::map
-#include <ostream>    // std::ostream
-#include <set>        // std::set
-#include <span>       // std::span
-#include <string>     // std::string
-#include <utility>    // std::pair
-#include <vector>     // std::vector
+#include <filesystem>  // std::filesystem
+#include <map>         // std::map
+#include <ostream>     // std::ostream
+#include <set>         // std::set
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <utility>     // std::pair
+#include <vector>      // std::vector
 
 #define CLI_ENSURE(condition, message)                                         \
   if (!(condition)) {                                                          \
@@ -26,11 +27,41 @@ auto parse_options(const std::span<const std::string> &arguments,
                    const std::set<std::string> &flags)
     -> std::map<std::string, std::vector<std::string>>;
 
+auto for_each_json_path(const std::vector<std::string> &arguments,
+                        const std::set<std::string> &extensions)
+    -> std::vector<std::filesystem::path>;
+
 auto for_each_json(const std::vector<std::string> &arguments,
                    const std::set<std::string> &extensions)
     -> std::vector<
         std::pair<std::filesystem::path, sourcemeta::jsontoolkit::JSON>>;
 
+auto pretty_evaluate_error(
+    std::ostream &stream,
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate::value_type &step,
+    const sourcemeta::jsontoolkit::Pointer &evaluate_path,
+    const sourcemeta::jsontoolkit::Pointer &instance_location) -> void;
+
+// Evaluate an instance in fast mode, printing every error to the stream
+auto pretty_evaluate(
+    const sourcemeta::jsontoolkit::SchemaCompilerTemplate &schema_template,
+    const sourcemeta::jsontoolkit::JSON &instance, std::ostream &stream)
+    -> bool;
+
+auto pretty_lint_error(std::ostream &stream, const std::filesystem::path &path,
+                       const sourcemeta::jsontoolkit::Pointer &pointer,
+                       const std::string_view name,
+                       const std::string_view message) -> void;
+
+// The contents a schema file must have to be considered formatted
+auto prettify_schema(const sourcemeta::jsontoolkit::JSON &schema)
+    -> std::string;
+
+auto pretty_format_error(std::ostream &stream,
+                         const std::filesystem::path &path,
+                         const std::string &contents,
+                         const std::string &expected) -> void;
+
 auto pretty_evaluate_callback(
     bool result,
     const sourcemeta::jsontoolkit::SchemaCompilerTemplate::value_type &,
@@ -0,0 +1,34 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "examples": [ 3.141592653589793, 0.1, -2.5, 0.0, 42 ],
+  "title": "Quote \" and backslash \\ and tab \t and \u0001 and ü",
+  "description": "A long enough string without anything to escape in it"
+}
+EOF
+
+"$1" fmt "$TMP/schema.json"
+
+cat << 'EOF' > "$TMP/expected.json"
+{
+  "title": "Quote \" and backslash \\ and tab \t and \u0001 and ü",
+  "description": "A long enough string without anything to escape in it",
+  "examples": [
+    3.141592653589793,
+    0.1,
+    -2.5,
+    0.0,
+    42
+  ]
+}
+EOF
+
+diff "$TMP/schema.json" "$TMP/expected.json"
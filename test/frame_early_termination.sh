@@ -0,0 +1,29 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+# The walker only looks at subschemas as it reaches them, so framing stops at
+# the first invalid subschema without resolving the dialect of the next one
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "https://json-schema.org/draft/2020-12/schema",
+  "properties": {
+    "bar": { "$id": 1 },
+    "foo": { "$schema": "https://example.com/unknown", "type": "string" }
+  }
+}
+EOF
+
+"$1" frame "$TMP/schema.json" 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.txt"
+Error: The value of the $id property is not valid
+EOF
+
+diff "$TMP/stderr.txt" "$TMP/expected.txt"
@@ -0,0 +1,91 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+# Rules fire at different depths, adding and removing keywords next to
+# subschemas that are yet to be transformed
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "https://json-schema.org/draft/2020-12/schema",
+  "type": "object",
+  "enum": [ { "foo": 1 } ],
+  "properties": {
+    "foo": { "type": "integer", "enum": [ 1 ] },
+    "bar": {
+      "items": {
+        "anyOf": [
+          { "enum": [ "baz" ] },
+          { "type": "string", "const": "qux" },
+          {
+            "properties": {
+              "baz": { "type": "boolean", "enum": [ true, false ] }
+            }
+          }
+        ]
+      },
+      "enum": [ [] ]
+    },
+    "baz": { "$ref": "#/$defs/qux" }
+  },
+  "$defs": {
+    "qux": { "type": "null", "enum": [ null ] }
+  }
+}
+EOF
+
+"$1" lint "$TMP/schema.json" --fix
+
+cat << 'EOF' > "$TMP/expected.json"
+{
+  "$schema": "https://json-schema.org/draft/2020-12/schema",
+  "const": {
+    "foo": 1
+  },
+  "properties": {
+    "bar": {
+      "const": [],
+      "items": {
+        "anyOf": [
+          {
+            "const": "baz"
+          },
+          {
+            "const": "qux"
+          },
+          {
+            "properties": {
+              "baz": {
+                "enum": [
+                  true,
+                  false
+                ]
+              }
+            }
+          }
+        ]
+      }
+    },
+    "baz": {
+      "$ref": "#/$defs/qux"
+    },
+    "foo": {
+      "const": 1
+    }
+  },
+  "$defs": {
+    "qux": {
+      "const": null
+    }
+  }
+}
+EOF
+
+diff "$TMP/schema.json" "$TMP/expected.json"
+
+# Nothing is left to fix
+"$1" lint "$TMP/schema.json"
@@ -0,0 +1,47 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "type": "string"
+    }
+  }
+}
+EOF
+
+mkdir "$TMP/instances"
+
+cat << 'EOF' > "$TMP/instances/instance_1.json"
+{ "foo": "bar" }
+EOF
+
+cat << 'EOF' > "$TMP/instances/instance_2.json"
+{ "foo": 1 }
+EOF
+
+cat << 'EOF' > "$TMP/instances/instance_3.json"
+{ "foo":
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instances" \
+  > "$TMP/output" 2> "$TMP/stderr" && CODE="$?" || CODE="$?"
+
+if [ "$CODE" = "0" ]
+then
+  echo "FAIL" 1>&2
+  exit 1
+fi
+
+grep --quiet "1 passed, 2 failed" "$TMP/output"
+grep --quiet "FAIL: $TMP/instances/instance_2.json" "$TMP/stderr"
+grep --quiet "FAIL: $TMP/instances/instance_3.json" "$TMP/stderr"
+echo "PASS" 1>&2
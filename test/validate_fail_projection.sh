@@ -0,0 +1,54 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "id": { "type": "integer" }
+  }
+}
+EOF
+
+# The schema never reads the payload, but it must still be valid JSON
+cat << 'EOF' > "$TMP/instance.json"
+{ "payload": { "nested": [ 1, 2, ] }, "id": 1 }
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" && CODE="$?" || CODE="$?"
+
+if [ "$CODE" = "0" ]
+then
+  echo "FAIL" 1>&2
+  exit 1
+fi
+
+# Values compared in full must be read in full
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "tags": { "items": { "enum": [ { "name": "a", "extra": [ 1 ] } ] } }
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+{ "tags": [ { "name": "a", "extra": [ 2 ] } ] }
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" && CODE="$?" || CODE="$?"
+
+if [ "$CODE" = "0" ]
+then
+  echo "FAIL" 1>&2
+  exit 1
+else
+  echo "PASS" 1>&2
+fi
@@ -0,0 +1,72 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": { "type": "string" },
+    "bar": { "type": "string" },
+    "baz": { "type": "string" }
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+{ "foo": 1, "bar": 2, "baz": 3 }
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" \
+  --output basic --max-errors 2 > "$TMP/output.json" \
+  && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":false,"errors":[{"error":"The target document is expected to be of the given type","instanceLocation":"/bar","keywordLocation":"/properties/bar/type"},{"error":"The target document is expected to be of the given type","instanceLocation":"/baz","keywordLocation":"/properties/baz/type"}]}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
+
+# The limit only makes sense when errors are listed
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --max-errors 2 \
+  2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.txt"
+Error: The maximum number of errors only applies to the basic and detailed output formats
+EOF
+
+diff "$TMP/stderr.txt" "$TMP/expected.txt"
+
+# The limit must be a positive integer that fits in memory
+for VALUE in 0 foo 99999999999999999999999
+do
+  "$1" validate "$TMP/schema.json" "$TMP/instance.json" --output basic \
+    --max-errors "$VALUE" 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+  test "$CODE" = "1"
+  echo "Error: The maximum number of errors must be a positive integer: $VALUE" \
+    > "$TMP/expected.txt"
+  diff "$TMP/stderr.txt" "$TMP/expected.txt"
+done
+
+# A negative number looks like another option, so the limit is missing
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --output basic \
+  --max-errors -1 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.txt"
+Error: The maximum number of errors must be a positive integer: 
+EOF
+
+diff "$TMP/stderr.txt" "$TMP/expected.txt"
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --output basic \
+  --max-errors 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+diff "$TMP/stderr.txt" "$TMP/expected.txt"
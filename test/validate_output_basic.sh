@@ -0,0 +1,60 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "anyOf": [ { "type": "string" }, { "type": "integer" } ]
+    }
+  },
+  "items": {
+    "type": "string"
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/object.json"
+{ "foo": 1 }
+EOF
+
+cat << 'EOF' > "$TMP/array.json"
+[ 1, "bar", 2 ]
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/object.json" --output basic \
+  > "$TMP/output.json"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":true}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
+
+# Every item fails at the same evaluate path, but is only reported once
+"$1" validate "$TMP/schema.json" "$TMP/array.json" --output basic \
+  > "$TMP/output.json" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":false,"errors":[{"error":"The target document is expected to be of the given type","instanceLocation":"/0","keywordLocation":"/items/type"},{"error":"Loop over the items of the target array","instanceLocation":"","keywordLocation":"/items"}]}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
+
+"$1" validate "$TMP/schema.json" "$TMP/array.json" --output flag \
+  > "$TMP/output.json" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":false}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
@@ -0,0 +1,53 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "$id": "https://example.com/schema",
+  "items": {
+    "type": "string"
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+[ "foo", 1 ]
+EOF
+
+# Only schemas with an absolute base URI have absolute keyword locations
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --output basic \
+  > "$TMP/output.json" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":false,"errors":[{"absoluteKeywordLocation":"https://example.com/schema#/items/type","error":"The target document is expected to be of the given type","instanceLocation":"/1","keywordLocation":"/items/type"},{"absoluteKeywordLocation":"https://example.com/schema#/items","error":"Loop over the items of the target array","instanceLocation":"","keywordLocation":"/items"}]}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
+
+# Without an identifier, there is nothing to make them absolute against
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "items": {
+    "type": "string"
+  }
+}
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --output basic \
+  > "$TMP/output.json" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"valid":false,"errors":[{"error":"The target document is expected to be of the given type","instanceLocation":"/1","keywordLocation":"/items/type"},{"error":"Loop over the items of the target array","instanceLocation":"","keywordLocation":"/items"}]}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
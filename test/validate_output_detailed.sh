@@ -0,0 +1,33 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "anyOf": [ { "type": "string" }, { "type": "integer" } ]
+    }
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+{ "foo": true }
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json" --output detailed \
+  > "$TMP/output.json" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+cat << 'EOF' > "$TMP/expected.json"
+{"errors":[{"error":"The target is expected to match all of the given assertions","errors":[{"error":"The target is expected to match at least one of the given assertions","errors":[{"error":"The target document is expected to be of the given type","instanceLocation":"/foo","keywordLocation":"/properties/foo/anyOf/0/type"},{"error":"The target document is expected to be of the given type","instanceLocation":"/foo","keywordLocation":"/properties/foo/anyOf/1/type"}],"instanceLocation":"/foo","keywordLocation":"/properties/foo/anyOf"}],"instanceLocation":"","keywordLocation":"/properties"}],"instanceLocation":"","keywordLocation":"","valid":false}
+EOF
+
+diff "$TMP/output.json" "$TMP/expected.json"
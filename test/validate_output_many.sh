@@ -0,0 +1,41 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "type": "string"
+}
+EOF
+
+mkdir "$TMP/instances"
+echo '"foo"' > "$TMP/instances/pass.json"
+echo '1' > "$TMP/instances/fail.json"
+
+cat << 'EOF' > "$TMP/expected.txt"
+The output formats only support validating one instance
+EOF
+
+# Each instance would need its own output document, so there is no single
+# document to write
+for FORMAT in flag basic detailed
+do
+  "$1" validate "$TMP/schema.json" "$TMP/instances/pass.json" \
+    "$TMP/instances/fail.json" --output "$FORMAT" \
+    > "$TMP/stdout.txt" 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+  test "$CODE" = "1"
+  test ! -s "$TMP/stdout.txt"
+  diff "$TMP/stderr.txt" "$TMP/expected.txt"
+
+  "$1" validate "$TMP/schema.json" "$TMP/instances" --output "$FORMAT" \
+    > "$TMP/stdout.txt" 2> "$TMP/stderr.txt" && CODE="$?" || CODE="$?"
+  test "$CODE" = "1"
+  test ! -s "$TMP/stdout.txt"
+  diff "$TMP/stderr.txt" "$TMP/expected.txt"
+done
@@ -0,0 +1,38 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "type": "string"
+    }
+  }
+}
+EOF
+
+mkdir -p "$TMP/instances/nested"
+
+cat << 'EOF' > "$TMP/instances/instance_1.json"
+{ "foo": "bar" }
+EOF
+
+cat << 'EOF' > "$TMP/instances/nested/instance_2.json"
+{ "foo": "baz" }
+EOF
+
+# Not matching the default extension
+cat << 'EOF' > "$TMP/instances/instance_3.txt"
+{ "foo": 1 }
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instances" > "$TMP/output"
+
+grep --quiet "2 passed, 0 failed" "$TMP/output"
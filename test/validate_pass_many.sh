@@ -0,0 +1,32 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "type": "string"
+    }
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance_1.json"
+{ "foo": "bar" }
+EOF
+
+cat << 'EOF' > "$TMP/instance_2.json"
+{ "foo": "baz" }
+EOF
+
+"$1" validate "$TMP/schema.json" \
+  "$TMP/instance_1.json" "$TMP/instance_2.json" > "$TMP/output"
+
+grep --quiet "2 passed, 0 failed" "$TMP/output"
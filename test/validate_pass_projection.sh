@@ -0,0 +1,29 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "required": [ "id" ],
+  "properties": {
+    "id": { "type": "integer" },
+    "tags": { "items": { "enum": [ { "name": "a" }, { "name": "b" } ] } }
+  }
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+{
+  "payload": { "nested": [ 1, 2.5e3, "xA\n", true, null, { "y": [] } ] },
+  "id": 1,
+  "tags": [ { "name": "b" }, { "name": "a" } ]
+}
+EOF
+
+"$1" validate "$TMP/schema.json" "$TMP/instance.json"
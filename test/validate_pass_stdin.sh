@@ -0,0 +1,26 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+cat << 'EOF' > "$TMP/schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "type": "object"
+    }
+  }
+}
+EOF
+
+# Instances that are not regular files cannot be memory-mapped
+echo '{ "foo": {} }' | "$1" validate "$TMP/schema.json" /dev/stdin
+
+echo '{ "foo": 1 }' | "$1" validate "$TMP/schema.json" /dev/stdin \
+  2> /dev/null && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
@@ -0,0 +1,117 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { rm -rf "$TMP"; }
+trap clean EXIT
+
+# Instances are parsed through a projection of what the schema reads, so for
+# every keyword that needs to see more of the instance than its own location,
+# check that the result matches the one of validating a fully parsed instance,
+# both for single instances and for directories of instances
+check() {
+  NAME="$1"
+  EXPECTED="$2"
+  mkdir -p "$TMP/$NAME"
+  cat > "$TMP/$NAME/instance.json"
+
+  "$3" validate "$TMP/$NAME.schema.json" "$TMP/$NAME/instance.json" \
+    > /dev/null 2>&1 && CODE="$?" || CODE="$?"
+  if [ "$CODE" != "$EXPECTED" ]
+  then
+    echo "FAIL: $NAME (single instance): expected $EXPECTED, got $CODE" 1>&2
+    exit 1
+  fi
+
+  "$3" validate "$TMP/$NAME.schema.json" "$TMP/$NAME" \
+    > /dev/null 2>&1 && CODE="$?" || CODE="$?"
+  if [ "$CODE" != "$EXPECTED" ]
+  then
+    echo "FAIL: $NAME (directory): expected $EXPECTED, got $CODE" 1>&2
+    exit 1
+  fi
+
+  rm -rf "$TMP/$NAME"
+}
+
+cat << 'EOF' > "$TMP/property_names.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": { "propertyNames": { "maxLength": 3 } }
+  }
+}
+EOF
+
+echo '{ "foo": { "abcdef": 1 } }' | check property_names 1 "$1"
+echo '{ "foo": { "abc": 1 } }' | check property_names 0 "$1"
+
+cat << 'EOF' > "$TMP/contains.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": { "contains": { "const": { "bar": [ 1 ] } } }
+  }
+}
+EOF
+
+echo '{ "foo": [ { "bar": [ 2 ] } ] }' | check contains 1 "$1"
+echo '{ "foo": [ 1, { "bar": [ 1 ] } ] }' | check contains 0 "$1"
+
+cat << 'EOF' > "$TMP/unique_items.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": { "uniqueItems": true }
+  }
+}
+EOF
+
+echo '{ "foo": [ { "bar": 1 }, { "bar": 1 } ] }' | check unique_items 1 "$1"
+echo '{ "foo": [ { "bar": 1 }, { "bar": 2 } ] }' | check unique_items 0 "$1"
+
+cat << 'EOF' > "$TMP/additional_properties.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "properties": { "bar": true },
+      "additionalProperties": { "type": "string" }
+    }
+  }
+}
+EOF
+
+echo '{ "foo": { "bar": 1, "baz": 2 } }' | check additional_properties 1 "$1"
+echo '{ "foo": { "bar": 1, "baz": "x" } }' | check additional_properties 0 "$1"
+
+cat << 'EOF' > "$TMP/pattern_properties.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "foo": {
+      "patternProperties": { "^x-": { "type": "integer" } },
+      "additionalProperties": false
+    }
+  }
+}
+EOF
+
+echo '{ "foo": { "x-bar": "baz" } }' | check pattern_properties 1 "$1"
+echo '{ "foo": { "bar": 1 } }' | check pattern_properties 1 "$1"
+echo '{ "foo": { "x-bar": 1 } }' | check pattern_properties 0 "$1"
+
+cat << 'EOF' > "$TMP/recursive_ref.schema.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "properties": {
+    "child": { "$ref": "#" },
+    "value": { "type": "integer" }
+  }
+}
+EOF
+
+echo '{ "child": { "child": { "value": "x" } } }' | check recursive_ref 1 "$1"
+echo '{ "child": { "child": { "value": 1 } } }' | check recursive_ref 0 "$1"
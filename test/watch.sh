@@ -0,0 +1,92 @@
+#!/bin/sh
+
+set -o errexit
+set -o nounset
+
+TMP="$(mktemp -d)"
+clean() { kill "$PID" 2> /dev/null || true; rm -rf "$TMP"; }
+PID=""
+trap clean EXIT
+
+mkdir "$TMP/schemas"
+
+cat << 'EOF' > "$TMP/schemas/string.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "$id": "https://example.com/string",
+  "type": "string"
+}
+EOF
+
+cat << 'EOF' > "$TMP/schemas/main.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "$id": "https://example.com/main",
+  "allOf": [
+    {
+      "$ref": "string"
+    }
+  ]
+}
+EOF
+
+cat << 'EOF' > "$TMP/instance.json"
+"foo"
+EOF
+
+"$1" watch "$TMP/schemas" --socket "$TMP/socket" &
+PID="$!"
+
+ATTEMPTS="0"
+while [ ! -S "$TMP/socket" ]
+do
+  ATTEMPTS="$((ATTEMPTS + 1))"
+  if [ "$ATTEMPTS" -gt 100 ]
+  then
+    echo "The daemon did not start" 1>&2
+    exit 1
+  fi
+
+  sleep 0.1
+done
+
+"$1" query "$TMP/socket" lint
+"$1" query "$TMP/socket" fmt "$TMP/schemas/main.json"
+"$1" query "$TMP/socket" validate "$TMP/schemas/main.json" "$TMP/instance.json"
+
+# Changing a schema affects the schemas that reference it
+cat << 'EOF' > "$TMP/schemas/string.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "$id": "https://example.com/string",
+  "type": "integer"
+}
+EOF
+
+"$1" query "$TMP/socket" validate "$TMP/schemas/main.json" "$TMP/instance.json" \
+  > "$TMP/output.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+grep --quiet "/allOf/0/\$ref/type" "$TMP/output.txt"
+
+# New schemas are picked up
+cat << 'EOF' > "$TMP/schemas/enum.json"
+{
+  "$schema": "http://json-schema.org/draft-07/schema#",
+  "enum": [ "foo" ]
+}
+EOF
+
+"$1" query "$TMP/socket" lint "$TMP/schemas/enum.json" \
+  > "$TMP/output.txt" && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+grep --quiet "(enum_to_const)" "$TMP/output.txt"
+
+# And removed schemas are forgotten
+rm "$TMP/schemas/enum.json"
+"$1" query "$TMP/socket" lint "$TMP/schemas/enum.json" \
+  && CODE="$?" || CODE="$?"
+test "$CODE" = "1"
+
+kill "$PID"
+wait "$PID"
+test ! -e "$TMP/socket"